@@ -50,11 +50,14 @@ int main(int argc, char **argv)
     double nextDeparture = SIM_TIME;  // Time for next departure
     unsigned int n = 0;           // Actual number of customers in the system
 
+    unsigned int arrivals = 0;    // Total number of arrivals
+    unsigned int blocked = 0;     // Arrivals that found the system full
     unsigned int departures = 0;  // Total number of customers served
     double busyTime = 0.0;        // Total busy time
     double s = 0.0;               // Area of number of customers in system
     double lastEventTime = time;  // Variable for "last event time"
     double lastBusyTime;          // Variable for "last start of busy time"
+    double pb;    // Blocking probability
     double x;     // Throughput rate
     double u;     // Utilization of system
     double l;     // Average number of customers in system
@@ -90,9 +93,10 @@ int main(int argc, char **argv)
         if (nextArrival < nextDeparture)
         {
             time = nextArrival;
+            s = s + n * (time - lastEventTime);  // Update area under "s" curve
+            arrivals++;
             if (n < k)  // Actual number of customers is less than system's capacity
             {
-                s = s + n * (time - lastEventTime);  // Update area under "s" curve
                 n++;    // Customers in system increase
                 if (n == 1)
                 {
@@ -100,6 +104,8 @@ int main(int argc, char **argv)
                     nextDeparture = time + expntl(departTime);
                 }
             }
+            else
+                blocked++;  // System full, customer is lost
             lastEventTime = time;   // "last event time" for next event
             nextArrival = time + expntl(arrTime);
         }
@@ -123,6 +129,7 @@ int main(int argc, char **argv)
     }
 
     // Compute outputs
+    pb = (double) blocked / arrivals;   // Blocking probability
     x = departures / time;  // Compute throughput rate
     u = busyTime / time;    // Compute server utilization
     l = s / time;           // Avg number of customers in the system
@@ -136,10 +143,12 @@ int main(int argc, char **argv)
     printf("-    Total simulation time        = %.4f sec \n", endTime);
     printf("-    Mean time between arrivals   = %.4f sec \n", arrTime);
     printf("-    Mean service time            = %.4f sec \n", departTime);
-    printf("-    System capacity              = %d sec \n", k);
+    printf("-    System capacity              = %d cust \n", k);
     printf("<-------------------------------------------------------------> \n");
     printf("-  OUTPUTS: \n");
     printf("-    # of Customers served        = %u cust \n", departures);
+    printf("-    # of Blocked arrivals        = %u cust \n", blocked);
+    printf("-    Blocking probability         = %f %% \n", 100.0 * pb);
     printf("-    Throughput rate              = %f cust/sec \n", x);
     printf("-    Server utilization           = %f %% \n", 100.0 * u);
     printf("-    Avg # of cust. in system     = %f cust \n", l);
@@ -0,0 +1,571 @@
+/*******************************************************************************
+*                         M/M/c/k Queue Simulator
+********************************************************************************
+* Notes: Multi-server queue with finite capacity "k" (customers in service plus
+* customers waiting). Arrivals finding the system full are blocked and either
+* join an orbit (with probability "p") to retry later, or are lost.
+* Optionally, customers finding all servers busy may balk (probability "b"),
+* and waiting customers may renege after an exponential patience time.
+* Pending abandonments are kept in a binary min-heap, so each queue operation
+* costs O(log(k-c)) regardless of how many customers are waiting.
+*------------------------------------------------------------------------------*
+* Build Command:
+* gcc -o mmck mmck.c -lm
+*------------------------------------------------------------------------------*
+* Execute command:
+* ./mmck
+*------------------------------------------------------------------------------*
+* Author: Lucas German Wals Ochoa
+*******************************************************************************/
+
+/*******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdio.h>              // Needed for printf()
+#include <stdlib.h>             // Needed for exit(), malloc() and free()
+#include <unistd.h>             // Needed for getopts()
+#include <stdbool.h>            // Needed for bool type
+#include "utils.h"              // Needed for expntl() and ranf()
+
+/*******************************************************************************
+* Defined constants and variables
+* NOTE: All TIME constants are defined in seconds!
+*******************************************************************************/
+#define SIM_TIME   1.0e9        // Simulation time
+#define ARR_TIME   90.00        // Mean time between arrivals
+#define SERV_TIME  60.00        // Mean service time
+#define NUM_SERVERS  10         // Number of servers in the system
+#define CAPACITY   20           // Maximum amount of customers in the system
+#define PATIENCE   0.0          // Mean patience time (0 = no reneging)
+#define BALK_PROB  0.0          // Probability of balking when servers are busy
+#define RETRY_PROB 0.0          // Probability of a blocked customer retrying
+#define RETRY_TIME 90.00        // Mean time between retrials of a customer
+#define NO_EVENT   1.0e30       // Time used for an event that is not scheduled
+
+/*******************************************************************************
+* Waiting room structures
+* Waiting customers occupy one of the (k-c) slots. Slots are linked in FIFO
+* order, and the abandonment deadline of each slot lives in a min-heap which
+* keeps track of the heap position of every slot, so a customer that starts
+* service can be removed from the heap without searching for it.
+*******************************************************************************/
+typedef struct
+{
+    int size;           // Number of customers waiting
+    int head;           // Slot of the first customer in line (-1 if empty)
+    int tail;           // Slot of the last customer in line (-1 if empty)
+    int freeSlot;       // First slot of the free list (-1 if full)
+    int *next;          // Next slot in line (or in the free list)
+    int *prev;          // Previous slot in line
+    int heapSize;       // Number of pending abandonments
+    int *heap;          // Heap of slots ordered by abandonment deadline
+    int *heapPos;       // Position of each slot inside the heap
+    double *deadline;   // Abandonment deadline of each slot
+} WaitingRoom;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void show_usage(char *name);
+int min_departure(double arr[], int capacity); // Find the index of the minimum departure time
+int idle_server(double arr[], int capacity);  // Position in array to store cust. departure time
+void room_init(WaitingRoom *room, int slots);       // Allocate waiting room
+void room_free(WaitingRoom *room);                  // Release waiting room
+void room_push(WaitingRoom *room, double deadline); // Customer joins the line
+void room_remove(WaitingRoom *room, int slot);      // Customer leaves the line
+static void heap_swap(WaitingRoom *room, int i, int j);
+static void heap_up(WaitingRoom *room, int i);
+static void heap_down(WaitingRoom *room, int i);
+
+/*******************************************************************************
+* Main Function
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    int opt;    // Hold the options passed as argument
+    double endTime = SIM_TIME;        // Total time to do Simulation
+    double arrTime = ARR_TIME;        // Mean time between arrivals
+    double departTime = SERV_TIME;    // Mean service time
+    int c = NUM_SERVERS;              // Number of servers in the system
+    int k = CAPACITY;                 // Capacity of system
+    double patience = PATIENCE;       // Mean patience time of waiting customers
+    double balkProb = BALK_PROB;      // Probability of balking
+    double retryProb = RETRY_PROB;    // Probability of joining the orbit
+    double retryTime = RETRY_TIME;    // Mean retrial time of each orbiting cust.
+
+    double time = 0.0;                  // Current Simulation time
+    double nextArrival = 0.0;           // Time for next arrival
+    double nextDeparture = NO_EVENT;    // Time for next departure
+    double nextRetrial = NO_EVENT;      // Time for next retrial from orbit
+    double nextAbandon = NO_EVENT;      // Time for next reneging customer
+    bool retrial;                       // Current arrival comes from the orbit
+
+    int nextDepartIndex = 0;            // Index of next departure time in array
+    int arrayIndex = 0;                 // Auxiliar variable
+    unsigned int n = 0;           // Actual number of customers in the system
+    unsigned int busy = 0;        // Actual number of busy servers
+    unsigned long orbit = 0;      // Actual number of customers in orbit
+    WaitingRoom room;             // Customers waiting for a server
+
+    unsigned long arrivals = 0;   // Total number of primary arrivals
+    unsigned long blocked = 0;    // Primary arrivals that found system full
+    unsigned long retrials = 0;   // Total number of retrial attempts
+    unsigned long retryBlocked = 0; // Retrials that found system full
+    unsigned long lost = 0;       // Blocked customers that gave up
+    unsigned long balked = 0;     // Customers that balked
+    unsigned long reneged = 0;    // Customers that abandoned the line
+    unsigned long departures = 0; // Total number of customers served
+    double busyArea = 0.0;        // Area of number of busy servers
+    double s = 0.0;               // Area of number of customers in system
+    double sq = 0.0;              // Area of number of customers waiting
+    double so = 0.0;              // Area of number of customers in orbit
+    double lastEventTime = time;  // Variable for "last event time"
+    double pb;    // Blocking probability
+    double x;     // Throughput rate
+    double u;     // Utilization of servers
+    double l;     // Average number of customers in system
+    double lq;    // Average number of customers waiting
+    double lo;    // Average number of customers in orbit
+    double w;     // Average Sojourn time
+    double wq;    // Average waiting time
+
+    if (argc > 1)
+    {
+        while ( (opt = getopt(argc, argv, "a:d:s:c:k:r:b:p:t:")) != -1 )
+        {
+            switch (opt) {
+                case 'a':
+                    arrTime = atof(optarg);
+                    break;
+                case 'd':
+                    departTime = atof(optarg);
+                    break;
+                case 's':
+                    endTime = atof(optarg);
+                    break;
+                case 'c':
+                    c = atoi(optarg);
+                    break;
+                case 'k':
+                    k = atoi(optarg);
+                    break;
+                case 'r':
+                    patience = atof(optarg);
+                    break;
+                case 'b':
+                    balkProb = atof(optarg);
+                    break;
+                case 'p':
+                    retryProb = atof(optarg);
+                    break;
+                case 't':
+                    retryTime = atof(optarg);
+                    break;
+                default:    // '?' unknown option
+                    show_usage( argv[0] );
+            }
+        }
+    }
+
+    if (c < 1 || k < c)
+    {
+        printf("Invalid parameters: need c >= 1 and k >= c \n");
+        show_usage( argv[0] );
+    }
+
+    double *custDepartures = malloc(c * sizeof(double)); // Departure times of serving customers
+    if (custDepartures == NULL)
+    {
+        printf("Not enough memory for %d servers \n", c);
+        exit(EXIT_FAILURE);
+    }
+    for (int i=0; i < c; i++)
+        custDepartures[i] = NO_EVENT;   // Fill the array with maximum time
+    room_init(&room, k - c);
+
+    // Simulation loop
+    while (time < endTime)
+    {
+        double nextEvent = nextArrival;
+        if (nextRetrial < nextEvent)
+            nextEvent = nextRetrial;
+        if (nextDeparture < nextEvent)
+            nextEvent = nextDeparture;
+        if (nextAbandon < nextEvent)
+            nextEvent = nextAbandon;
+
+        time = nextEvent;
+        s = s + n * (time - lastEventTime);         // Update area under "s" curve
+        sq = sq + room.size * (time - lastEventTime);
+        so = so + orbit * (time - lastEventTime);
+        busyArea = busyArea + busy * (time - lastEventTime);
+        lastEventTime = time;   // "last event time" for next event
+
+        // Arrival occurred (either primary or from the orbit)
+        if (time == nextArrival || time == nextRetrial)
+        {
+            retrial = (time != nextArrival);
+            if (retrial)
+            {
+                retrials++;
+                orbit--;
+            }
+            else
+            {
+                arrivals++;
+                nextArrival = time + expntl(arrTime);
+            }
+
+            if (n >= (unsigned int) k)    // System full, customer is blocked
+            {
+                if (retrial)
+                    retryBlocked++;
+                else
+                    blocked++;
+
+                if (retryProb > 0.0 && ranf() < retryProb)
+                    orbit++;    // Customer will try again later
+                else
+                    lost++;
+            }
+            else if (busy < (unsigned int) c)   // There is an idle server
+            {
+                n++;
+                busy++;
+                arrayIndex = idle_server(custDepartures, c);
+                custDepartures[arrayIndex] = time + expntl(departTime);
+                if (custDepartures[arrayIndex] < nextDeparture)
+                {
+                    nextDepartIndex = arrayIndex;
+                    nextDeparture = custDepartures[nextDepartIndex];
+                }
+            }
+            else if (balkProb > 0.0 && ranf() < balkProb)
+                balked++;   // All servers busy, customer does not join
+            else            // Customer joins the line
+            {
+                n++;
+                room_push(&room, patience > 0.0 ? time + expntl(patience) : NO_EVENT);
+            }
+
+            // Exponential retrials are memoryless, so the orbit as a whole
+            // retries at a rate proportional to its size
+            if (retrial || orbit > 0)
+                nextRetrial = (orbit > 0) ? time + expntl(retryTime / orbit) : NO_EVENT;
+        }
+        // Departure occurred
+        else if (time == nextDeparture)
+        {
+            n--;    // Customers in system decrease
+            departures++;           // Increment number of completions
+            custDepartures[nextDepartIndex] = NO_EVENT; // Set server as empty
+            if (room.size > 0)  // First customer in line takes the server
+            {
+                room_remove(&room, room.head);
+                custDepartures[nextDepartIndex] = time + expntl(departTime);
+            }
+            else
+                busy--;
+            // Look for the next departure time
+            nextDepartIndex = min_departure(custDepartures, c);
+            nextDeparture = custDepartures[nextDepartIndex];
+        }
+        // Abandonment occurred
+        else
+        {
+            n--;
+            reneged++;
+            room_remove(&room, room.heap[0]);
+        }
+
+        nextAbandon = (room.heapSize > 0) ? room.deadline[room.heap[0]] : NO_EVENT;
+    }
+
+    // Compute outputs
+    pb = (arrivals > 0) ? (double) blocked / arrivals : 0.0; // Blocking probability
+    x = departures / time;      // Compute throughput rate
+    u = busyArea / (c * time);  // Compute server utilization
+    l = s / time;               // Avg number of customers in the system
+    lq = sq / time;             // Avg number of customers waiting
+    lo = so / time;             // Avg number of customers in orbit
+    // Little's law over every customer admitted (served or reneged)
+    w = l / ((departures + reneged) / time);    // Avg Sojourn time
+    wq = lq / ((departures + reneged) / time);  // Avg waiting time
+
+    // Output results
+    printf("<-------------------------------------------------------------> \n");
+    printf("<          *** Results for M/M/%d/%d simulation ***           > \n", c, k);
+    printf("<-------------------------------------------------------------> \n");
+    printf("-  INPUTS: \n");
+    printf("-    Total simulation time        = %.4f sec \n", endTime);
+    printf("-    Mean time between arrivals   = %.4f sec \n", arrTime);
+    printf("-    Mean service time            = %.4f sec \n", departTime);
+    printf("-    # of Servers in system       = %d servers \n", c);
+    printf("-    System capacity              = %d cust \n", k);
+    printf("-    Mean patience time           = %.4f sec \n", patience);
+    printf("-    Balking probability          = %.4f \n", balkProb);
+    printf("-    Retrial probability          = %.4f \n", retryProb);
+    printf("-    Mean retrial time            = %.4f sec \n", retryTime);
+    printf("<-------------------------------------------------------------> \n");
+    printf("-  OUTPUTS: \n");
+    printf("-    # of Arrivals                = %lu cust \n", arrivals);
+    printf("-    # of Customers served        = %lu cust \n", departures);
+    printf("-    # of Blocked arrivals        = %lu cust \n", blocked);
+    printf("-    # of Retrials (blocked)      = %lu (%lu) \n", retrials, retryBlocked);
+    printf("-    # of Customers lost          = %lu cust \n", lost);
+    printf("-    # of Customers balked        = %lu cust \n", balked);
+    printf("-    # of Customers reneged       = %lu cust \n", reneged);
+    printf("-    Blocking probability         = %f %% \n", 100.0 * pb);
+    printf("-    Effective throughput rate    = %f cust/sec \n", x);
+    printf("-    Server utilization           = %f %% \n", 100.0 * u);
+    printf("-    Avg # of cust. in system     = %f cust \n", l);
+    printf("-    Avg # of cust. in queue      = %f cust \n", lq);
+    printf("-    Avg # of cust. in orbit      = %f cust \n", lo);
+    printf("-    Mean Sojourn time            = %f sec \n", w);
+    printf("-    Mean Waiting time            = %f sec \n", wq);
+    printf("<-------------------------------------------------------------> \n");
+
+    room_free(&room);
+    free(custDepartures);
+}
+
+/*******************************************************************************
+*       min_departure(double arr[], int capacity)
+********************************************************************************
+* Function that return the index of the minimum departure time
+* - Input: arr (array of departures)
+* - Input: capacity (size of the array)
+*******************************************************************************/
+int min_departure(double arr[], int capacity)
+{
+    int index = 0;
+
+    for (int i=1; i < capacity; i++)
+    {
+        if (arr[i] < arr[index])
+            index = i;
+    }
+    return index;
+}
+
+/*******************************************************************************
+*       idle_server(double arr[], int capacity)
+********************************************************************************
+* Function that return the index of an "idle server"
+* It's used to determine to which position of the array we will save the
+* departure time of the client (which server is serving the customer)
+* - Input: arr (array of departures)
+* - Input: capacity (size of the array)
+*******************************************************************************/
+int idle_server(double arr[], int capacity)
+{
+    for (int i=0; i < capacity; i++)
+    {
+        if (arr[i] == NO_EVENT)
+            return i;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+*       room_init(WaitingRoom *room, int slots)
+********************************************************************************
+* Function that allocates a waiting room with all its slots free
+* - Input: room (waiting room to initialize)
+* - Input: slots (maximum number of waiting customers, k - c)
+*******************************************************************************/
+void room_init(WaitingRoom *room, int slots)
+{
+    // Allocate at least one slot so a room with no space is still valid
+    int size = (slots > 0) ? slots : 1;
+
+    room->size = 0;
+    room->head = -1;
+    room->tail = -1;
+    room->heapSize = 0;
+    room->next = malloc(size * sizeof(int));
+    room->prev = malloc(size * sizeof(int));
+    room->heap = malloc(size * sizeof(int));
+    room->heapPos = malloc(size * sizeof(int));
+    room->deadline = malloc(size * sizeof(double));
+    if (!room->next || !room->prev || !room->heap || !room->heapPos || !room->deadline)
+    {
+        printf("Not enough memory for %d waiting customers \n", slots);
+        exit(EXIT_FAILURE);
+    }
+
+    // Chain all slots in the free list
+    room->freeSlot = (slots > 0) ? 0 : -1;
+    for (int i=0; i < slots; i++)
+        room->next[i] = (i + 1 < slots) ? i + 1 : -1;
+}
+
+/*******************************************************************************
+*       room_free(WaitingRoom *room)
+********************************************************************************
+* Function that releases the memory used by a waiting room
+* - Input: room (waiting room to release)
+*******************************************************************************/
+void room_free(WaitingRoom *room)
+{
+    free(room->next);
+    free(room->prev);
+    free(room->heap);
+    free(room->heapPos);
+    free(room->deadline);
+}
+
+/*******************************************************************************
+*       room_push(WaitingRoom *room, double deadline)
+********************************************************************************
+* Function that puts a customer at the end of the line. The caller must make
+* sure there is a free slot (the system holds less than k customers).
+* - Input: room (waiting room)
+* - Input: deadline (time at which the customer abandons, NO_EVENT if never)
+*******************************************************************************/
+void room_push(WaitingRoom *room, double deadline)
+{
+    int slot = room->freeSlot;
+
+    room->freeSlot = room->next[slot];
+    room->next[slot] = -1;
+    room->prev[slot] = room->tail;
+    if (room->tail >= 0)
+        room->next[room->tail] = slot;
+    else
+        room->head = slot;
+    room->tail = slot;
+    room->size++;
+
+    room->deadline[slot] = deadline;
+    room->heapPos[slot] = -1;
+    if (deadline < NO_EVENT)    // Only impatient customers get a timer
+    {
+        room->heap[room->heapSize] = slot;
+        room->heapPos[slot] = room->heapSize;
+        room->heapSize++;
+        heap_up(room, room->heapSize - 1);
+    }
+}
+
+/*******************************************************************************
+*       room_remove(WaitingRoom *room, int slot)
+********************************************************************************
+* Function that takes a customer out of the line, either because it starts
+* service or because it abandons, and cancels its pending abandonment
+* - Input: room (waiting room)
+* - Input: slot (slot of the customer to remove)
+*******************************************************************************/
+void room_remove(WaitingRoom *room, int slot)
+{
+    int pos = room->heapPos[slot];
+
+    if (pos >= 0)
+    {
+        room->heapSize--;
+        if (pos < room->heapSize)
+        {
+            heap_swap(room, pos, room->heapSize);
+            heap_up(room, pos);
+            heap_down(room, room->heapPos[room->heap[pos]]);
+        }
+        room->heapPos[slot] = -1;
+    }
+
+    if (room->prev[slot] >= 0)
+        room->next[room->prev[slot]] = room->next[slot];
+    else
+        room->head = room->next[slot];
+    if (room->next[slot] >= 0)
+        room->prev[room->next[slot]] = room->prev[slot];
+    else
+        room->tail = room->prev[slot];
+    room->size--;
+
+    room->next[slot] = room->freeSlot;
+    room->freeSlot = slot;
+}
+
+/*******************************************************************************
+*       heap_swap(WaitingRoom *room, int i, int j)
+********************************************************************************
+* Function that exchanges two heap entries keeping positions up to date
+*******************************************************************************/
+static void heap_swap(WaitingRoom *room, int i, int j)
+{
+    int aux = room->heap[i];
+
+    room->heap[i] = room->heap[j];
+    room->heap[j] = aux;
+    room->heapPos[room->heap[i]] = i;
+    room->heapPos[room->heap[j]] = j;
+}
+
+/*******************************************************************************
+*       heap_up(WaitingRoom *room, int i)
+********************************************************************************
+* Function that moves entry "i" towards the root while its deadline is earlier
+* than its parent's deadline
+*******************************************************************************/
+static void heap_up(WaitingRoom *room, int i)
+{
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (room->deadline[room->heap[parent]] <= room->deadline[room->heap[i]])
+            break;
+        heap_swap(room, i, parent);
+        i = parent;
+    }
+}
+
+/*******************************************************************************
+*       heap_down(WaitingRoom *room, int i)
+********************************************************************************
+* Function that moves entry "i" towards the leaves while any child has an
+* earlier deadline
+*******************************************************************************/
+static void heap_down(WaitingRoom *room, int i)
+{
+    while (true)
+    {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+
+        if (left < room->heapSize &&
+            room->deadline[room->heap[left]] < room->deadline[room->heap[smallest]])
+            smallest = left;
+        if (right < room->heapSize &&
+            room->deadline[room->heap[right]] < room->deadline[room->heap[smallest]])
+            smallest = right;
+        if (smallest == i)
+            break;
+        heap_swap(room, i, smallest);
+        i = smallest;
+    }
+}
+
+/*******************************************************************************
+*       show_usage(char *name)
+********************************************************************************
+* Function that return a message of how to use this program
+* - Input: name (the name of the executable)
+*******************************************************************************/
+static void show_usage(char *name)
+{
+    printf("\nUsage: \n");
+    printf("%s [option] value \n", name);
+    printf("\n");
+    printf("Options: \n");
+    printf("\t-a\tMean time between arrivals (in seconds) \n");
+    printf("\t-d\tMean service time (in seconds) \n");
+    printf("\t-s\tTotal simulation time (in seconds) \n");
+    printf("\t-c\tNumber of servers in the system\n");
+    printf("\t-k\tTotal capacity of the system (in # of customers) \n");
+    printf("\t-r\tMean patience time of waiting customers (0 = no reneging) \n");
+    printf("\t-b\tProbability of balking when all servers are busy \n");
+    printf("\t-p\tProbability of a blocked customer joining the orbit \n");
+    printf("\t-t\tMean time between retrials of an orbiting customer \n");
+    exit(EXIT_SUCCESS);
+}